@@ -0,0 +1,128 @@
+#include "benchmark_harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+namespace {
+
+// Two-sided 95% Student-t critical values for 1..30 degrees of freedom
+constexpr double kStudentT95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+double StudentT95(const int& degrees_of_freedom) {
+  if (degrees_of_freedom < 1) return 0.0;
+  if (degrees_of_freedom <= 30) return kStudentT95[degrees_of_freedom - 1];
+  return 1.960;
+}
+
+// Escape the few characters that can appear in our labels
+std::string JsonString(const std::string& value) {
+  std::string escaped = "\"";
+  for (const char c : value) {
+    if (c == '"' || c == '\\') escaped += '\\';
+    escaped += c;
+  }
+  return escaped + "\"";
+}
+
+}  // namespace
+
+SampleSummary Summarize(const std::vector<double>& samples) {
+  SampleSummary summary;
+  summary.repeats = static_cast<int>(samples.size());
+  if (samples.empty()) return summary;
+
+  const double n = static_cast<double>(samples.size());
+  summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+  double sum_sq = 0.0;
+  for (const double sample : samples) {
+    sum_sq += (sample - summary.mean) * (sample - summary.mean);
+  }
+  summary.stddev = samples.size() > 1 ? std::sqrt(sum_sq / (n - 1.0)) : 0.0;
+
+  const double half_width =
+      StudentT95(summary.repeats - 1) * summary.stddev / std::sqrt(n);
+  summary.ci95_low = summary.mean - half_width;
+  summary.ci95_high = summary.mean + half_width;
+
+  const auto [min_it, max_it] =
+      std::minmax_element(samples.begin(), samples.end());
+  summary.min = *min_it;
+  summary.max = *max_it;
+  return summary;
+}
+
+void BenchmarkReport::Add(const BenchmarkRecord& record) {
+  records_.push_back(record);
+}
+
+const std::vector<BenchmarkRecord>& BenchmarkReport::GetRecords() const {
+  return records_;
+}
+
+// Human-readable summary; the CSV/JSON files carry the full statistics
+void BenchmarkReport::PrintTable(std::ostream& out) const {
+  out << std::left << std::setw(20) << "suite" << std::setw(16) << "mode"
+      << std::right << std::setw(8) << "threads" << std::setw(12) << "size"
+      << "  " << std::left << std::setw(18) << "metric" << std::right
+      << std::setw(14) << "mean" << std::setw(14) << "+/- 95%" << '\n';
+  for (const auto& record : records_) {
+    const auto& s = record.summary;
+    out << std::left << std::setw(20) << record.suite << std::setw(16)
+        << record.mode << std::right << std::setw(8) << record.threads
+        << std::setw(12) << record.problem_size << "  " << std::left
+        << std::setw(18) << record.metric << std::right << std::setw(14)
+        << std::setprecision(6) << s.mean << std::setw(14)
+        << (s.ci95_high - s.mean) << '\n';
+  }
+}
+
+bool BenchmarkReport::WriteCsv(const std::string& path) const {
+  std::ofstream out(path);
+  if (!out) return false;
+
+  out << std::setprecision(10);
+  out << "suite,mode,threads,problem_size,metric,repeats,mean,stddev,"
+         "ci95_low,ci95_high,min,max\n";
+  for (const auto& record : records_) {
+    const auto& s = record.summary;
+    out << record.suite << ',' << record.mode << ',' << record.threads << ','
+        << record.problem_size << ',' << record.metric << ',' << s.repeats
+        << ',' << s.mean << ',' << s.stddev << ',' << s.ci95_low << ','
+        << s.ci95_high << ',' << s.min << ',' << s.max << '\n';
+  }
+  return static_cast<bool>(out);
+}
+
+// Records are written one per line so results diff cleanly between commits
+bool BenchmarkReport::WriteJson(const std::string& path, const int& repeats,
+                                const int& max_threads) const {
+  std::ofstream out(path);
+  if (!out) return false;
+
+  out << std::setprecision(10);
+  out << "{\n  \"repeats\": " << repeats
+      << ",\n  \"max_threads\": " << max_threads
+      << ",\n  \"results\": [\n";
+  for (std::size_t i = 0; i < records_.size(); ++i) {
+    const auto& record = records_[i];
+    const auto& s = record.summary;
+    out << "    {\"suite\": " << JsonString(record.suite)
+        << ", \"mode\": " << JsonString(record.mode)
+        << ", \"threads\": " << record.threads
+        << ", \"problem_size\": " << record.problem_size
+        << ", \"metric\": " << JsonString(record.metric)
+        << ", \"repeats\": " << s.repeats << ", \"mean\": " << s.mean
+        << ", \"stddev\": " << s.stddev << ", \"ci95_low\": " << s.ci95_low
+        << ", \"ci95_high\": " << s.ci95_high << ", \"min\": " << s.min
+        << ", \"max\": " << s.max << "}"
+        << (i + 1 < records_.size() ? "," : "") << '\n';
+  }
+  out << "  ]\n}\n";
+  return static_cast<bool>(out);
+}
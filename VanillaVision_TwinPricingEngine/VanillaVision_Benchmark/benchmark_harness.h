@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Mean, spread and 95% confidence interval of repeated measurements
+struct SampleSummary {
+  int repeats = 0;
+  double mean = 0.0;
+  double stddev = 0.0;
+  double ci95_low = 0.0;
+  double ci95_high = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+};
+
+// One measured metric of one benchmark configuration
+struct BenchmarkRecord {
+  std::string suite;   // e.g. "bs_throughput", "mc_strong_scaling"
+  std::string mode;    // e.g. "call", "multi_threaded", "greeks"
+  int threads = 1;
+  long long problem_size = 0;  // Options or scenarios per run
+  std::string metric;          // e.g. "options_per_sec", "abs_error"
+  SampleSummary summary;
+};
+
+class BenchmarkReport {
+ private:
+  std::vector<BenchmarkRecord> records_;
+
+ public:
+  void Add(const BenchmarkRecord& record);
+  const std::vector<BenchmarkRecord>& GetRecords() const;
+
+  void PrintTable(std::ostream& out) const;
+  bool WriteCsv(const std::string& path) const;
+  bool WriteJson(const std::string& path, const int& repeats,
+                 const int& max_threads) const;
+};
+
+SampleSummary Summarize(const std::vector<double>& samples);
+
+// Run fn once to warm up, then `repeats` times, returning each run's
+// wall-clock time in seconds.
+template <typename Fn>
+std::vector<double> MeasureSeconds(const int& repeats, Fn&& fn) {
+  fn(0);
+  std::vector<double> seconds;
+  seconds.reserve(repeats);
+  for (int i = 0; i < repeats; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    fn(i + 1);
+    const auto end = std::chrono::steady_clock::now();
+    seconds.push_back(std::chrono::duration<double>(end - start).count());
+  }
+  return seconds;
+}
@@ -0,0 +1,264 @@
+// Throughput, convergence and scaling benchmarks for the pricing engines.
+// Results are printed as a table and written to JSON and CSV files that can
+// be diffed between commits.
+
+#include <charconv>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark_harness.h"
+#include "black_scholes_model.h"
+#include "monte_carlo_simulation_engine.h"
+
+namespace {
+
+constexpr double S = 100.0;    // Spot price
+constexpr double K = 100.0;    // Strike price
+constexpr double T = 1.0;      // Time to maturity
+constexpr double r = 0.05;     // Risk-free rate
+constexpr double sigma = 0.2;  // Volatility
+constexpr unsigned int base_seed = 42;
+
+struct BenchmarkConfig {
+  int repeats = 10;
+  int max_threads = DefaultThreadCount();
+  bool quick = false;
+  std::string json_path = "benchmark_results.json";
+  std::string csv_path = "benchmark_results.csv";
+};
+
+// Distinct seed per run; threads inside a run use seed + thread index
+unsigned int RunSeed(const int& run_index) {
+  return base_seed + static_cast<unsigned int>(run_index) * 10007u;
+}
+
+void AddSamples(BenchmarkReport& report, const std::string& suite,
+                const std::string& mode, const int& threads,
+                const long long& problem_size, const std::string& metric,
+                const std::vector<double>& samples) {
+  report.Add({suite, mode, threads, problem_size, metric, Summarize(samples)});
+}
+
+std::vector<double> Scale(const std::vector<double>& samples,
+                          const double& factor, const bool& invert) {
+  std::vector<double> scaled;
+  scaled.reserve(samples.size());
+  for (const double sample : samples) {
+    scaled.push_back(invert ? factor / sample : factor * sample);
+  }
+  return scaled;
+}
+
+// 1, 2, 4, ... up to max_threads, always including max_threads itself
+std::vector<int> ThreadCounts(const int& max_threads) {
+  std::vector<int> counts;
+  for (int threads = 1; threads < max_threads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(max_threads);
+  return counts;
+}
+
+// Options priced per second by the analytical Black-Scholes kernels
+void RunBlackScholesThroughput(const BenchmarkConfig& config,
+                               BenchmarkReport& report) {
+  const int num_options = config.quick ? 100000 : 1000000;
+
+  std::mt19937 generator(base_seed);
+  std::uniform_real_distribution<double> spot(50.0, 150.0);
+  std::uniform_real_distribution<double> strike(50.0, 150.0);
+  std::uniform_real_distribution<double> maturity(0.1, 2.0);
+  std::uniform_real_distribution<double> rate(0.0, 0.1);
+  std::uniform_real_distribution<double> vol(0.05, 0.6);
+
+  std::vector<double> Ss(num_options), Ks(num_options), Ts(num_options),
+      rs(num_options), sigmas(num_options);
+  for (int i = 0; i < num_options; ++i) {
+    Ss[i] = spot(generator);
+    Ks[i] = strike(generator);
+    Ts[i] = maturity(generator);
+    rs[i] = rate(generator);
+    sigmas[i] = vol(generator);
+  }
+
+  volatile double sink = 0.0;  // Keeps the pricing loops from being elided
+  for (const bool is_call : {true, false}) {
+    const auto seconds = MeasureSeconds(config.repeats, [&](const int&) {
+      double total = 0.0;
+      for (int i = 0; i < num_options; ++i) {
+        total += is_call ? BlackScholesModel::CalculateCallPrice(
+                               Ss[i], Ks[i], Ts[i], rs[i], sigmas[i])
+                         : BlackScholesModel::CalculatePutPrice(
+                               Ss[i], Ks[i], Ts[i], rs[i], sigmas[i]);
+      }
+      sink = sink + total;
+    });
+    AddSamples(report, "bs_throughput", is_call ? "call" : "put", 1,
+               num_options, "options_per_sec",
+               Scale(seconds, num_options, true));
+  }
+}
+
+// Runs one Monte Carlo mode and returns its discounted price
+double RunMonteCarloMode(MonteCarloSimulation& simulation,
+                         const std::string& mode, const int& num_scenarios,
+                         const unsigned int& seed, const int& threads) {
+  if (mode == "single_threaded") {
+    return simulation.RunSingleThreadedSimulation(num_scenarios, seed).first;
+  }
+  if (mode == "multi_threaded") {
+    return simulation.RunMultiThreadedSimulation(num_scenarios, seed, threads)
+        .first;
+  }
+  return simulation.RunMultiThreadedGreeks(num_scenarios, seed, threads)
+      .price.value;
+}
+
+// Scenarios per second and absolute pricing error against Black-Scholes
+// across scenario counts, giving error versus wall-clock for each mode.
+void RunMonteCarloConvergence(const BenchmarkConfig& config,
+                              BenchmarkReport& report) {
+  MonteCarloSimulation simulation(S, K, T, r, sigma, OptionType::Call);
+  const double bs_price =
+      BlackScholesModel::CalculateCallPrice(S, K, T, r, sigma);
+  const int max_scenarios = config.quick ? 100000 : 1000000;
+
+  for (const std::string mode :
+       {"single_threaded", "multi_threaded", "greeks"}) {
+    const int threads = mode == "single_threaded" ? 1 : config.max_threads;
+    for (int num_scenarios = 1000; num_scenarios <= max_scenarios;
+         num_scenarios *= 10) {
+      std::vector<double> errors;
+      const auto seconds =
+          MeasureSeconds(config.repeats, [&](const int& run_index) {
+            const double price = RunMonteCarloMode(
+                simulation, mode, num_scenarios, RunSeed(run_index), threads);
+            if (run_index > 0) errors.push_back(std::abs(price - bs_price));
+          });
+      AddSamples(report, "mc_convergence", mode, threads, num_scenarios,
+                 "wallclock_ms", Scale(seconds, 1000.0, false));
+      AddSamples(report, "mc_convergence", mode, threads, num_scenarios,
+                 "scenarios_per_sec", Scale(seconds, num_scenarios, true));
+      AddSamples(report, "mc_convergence", mode, threads, num_scenarios,
+                 "abs_error", errors);
+    }
+  }
+}
+
+// Strong scaling: fixed total scenarios. Weak scaling: fixed scenarios per
+// thread. Speedup and efficiency are relative to the mean one-thread time.
+void RunMonteCarloScaling(const BenchmarkConfig& config,
+                          BenchmarkReport& report) {
+  MonteCarloSimulation simulation(S, K, T, r, sigma, OptionType::Call);
+  const int strong_scenarios = config.quick ? 200000 : 1000000;
+  const int weak_scenarios_per_thread = config.quick ? 50000 : 250000;
+
+  for (const std::string mode : {"multi_threaded", "greeks"}) {
+    double baseline = 0.0;
+    for (const int threads : ThreadCounts(config.max_threads)) {
+      const auto seconds =
+          MeasureSeconds(config.repeats, [&](const int& run_index) {
+            RunMonteCarloMode(simulation, mode, strong_scenarios,
+                              RunSeed(run_index), threads);
+          });
+      if (threads == 1) baseline = Summarize(seconds).mean;
+      AddSamples(report, "mc_strong_scaling", mode, threads, strong_scenarios,
+                 "wallclock_ms", Scale(seconds, 1000.0, false));
+      AddSamples(report, "mc_strong_scaling", mode, threads, strong_scenarios,
+                 "scenarios_per_sec", Scale(seconds, strong_scenarios, true));
+      AddSamples(report, "mc_strong_scaling", mode, threads, strong_scenarios,
+                 "speedup", Scale(seconds, baseline, true));
+      AddSamples(report, "mc_strong_scaling", mode, threads, strong_scenarios,
+                 "efficiency", Scale(seconds, baseline / threads, true));
+    }
+  }
+
+  for (const std::string mode : {"multi_threaded", "greeks"}) {
+    double baseline = 0.0;
+    for (const int threads : ThreadCounts(config.max_threads)) {
+      const int num_scenarios = weak_scenarios_per_thread * threads;
+      const auto seconds =
+          MeasureSeconds(config.repeats, [&](const int& run_index) {
+            RunMonteCarloMode(simulation, mode, num_scenarios,
+                              RunSeed(run_index), threads);
+          });
+      if (threads == 1) baseline = Summarize(seconds).mean;
+      AddSamples(report, "mc_weak_scaling", mode, threads, num_scenarios,
+                 "wallclock_ms", Scale(seconds, 1000.0, false));
+      AddSamples(report, "mc_weak_scaling", mode, threads, num_scenarios,
+                 "scenarios_per_sec", Scale(seconds, num_scenarios, true));
+      AddSamples(report, "mc_weak_scaling", mode, threads, num_scenarios,
+                 "efficiency", Scale(seconds, baseline, true));
+    }
+  }
+}
+
+void PrintUsage(const char* program) {
+  std::cerr << "Usage: " << program
+            << " [--repeats N] [--max-threads N] [--json PATH] [--csv PATH]"
+               " [--quick]\n";
+}
+
+// Parses a strictly positive integer option value
+bool ParsePositive(const std::string& value, int& result) {
+  const char* end = value.data() + value.size();
+  const auto [next, error] = std::from_chars(value.data(), end, result);
+  return error == std::errc() && next == end && result > 0;
+}
+
+bool ParseArguments(const int& argc, char** argv, BenchmarkConfig& config) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--quick") {
+      config.quick = true;
+    } else if (arg == "--repeats" && has_value) {
+      if (!ParsePositive(argv[++i], config.repeats)) return false;
+    } else if (arg == "--max-threads" && has_value) {
+      if (!ParsePositive(argv[++i], config.max_threads)) return false;
+    } else if (arg == "--json" && has_value) {
+      config.json_path = argv[++i];
+    } else if (arg == "--csv" && has_value) {
+      config.csv_path = argv[++i];
+    } else {
+      return false;
+    }
+  }
+  return config.repeats >= 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchmarkConfig config;
+  if (!ParseArguments(argc, argv, config)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  std::cout << "Repeats per configuration = " << config.repeats
+            << "; max threads = " << config.max_threads << '\n'
+            << '\n';
+
+  BenchmarkReport report;
+  RunBlackScholesThroughput(config, report);
+  RunMonteCarloConvergence(config, report);
+  RunMonteCarloScaling(config, report);
+
+  report.PrintTable(std::cout);
+
+  const bool json_ok = report.WriteJson(config.json_path, config.repeats,
+                                        config.max_threads);
+  const bool csv_ok = report.WriteCsv(config.csv_path);
+  if (!json_ok || !csv_ok) {
+    std::cerr << "Failed to write benchmark results\n";
+    return 1;
+  }
+  std::cout << '\n'
+            << "Results written to " << config.json_path << " and "
+            << config.csv_path << '\n';
+  return 0;
+}
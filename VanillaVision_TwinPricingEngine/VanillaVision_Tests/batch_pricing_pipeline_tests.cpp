@@ -0,0 +1,198 @@
+// Tests for the chain-file parsing of BatchPricingPipeline.
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "batch_pricing_pipeline.h"
+#include "test_harness.h"
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Writes contents to a temporary input file, prices it with Black-Scholes
+// and returns the number of records priced
+long long PriceFile(const std::string& name, const std::string& contents,
+                    const std::size_t& chunk_bytes = 8 << 20) {
+  const std::string input_path = TempPath(name);
+  {
+    std::ofstream input(input_path, std::ios::binary);
+    input << contents;
+  }
+
+  BatchPricingConfig config;
+  config.input_path = input_path;
+  config.output_path = TempPath(name + ".out.csv");
+  config.num_threads = 2;
+  config.chunk_bytes = chunk_bytes;
+  return BatchPricingPipeline(config).Run().num_records;
+}
+
+bool Rejects(const std::string& name, const std::string& contents,
+             const std::size_t& chunk_bytes = 8 << 20) {
+  try {
+    PriceFile(name, contents, chunk_bytes);
+  } catch (const std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream input(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(input),
+                     std::istreambuf_iterator<char>());
+}
+
+std::string BinaryRecord(const std::int32_t& type, const double& S = 100.0) {
+  const BinaryOptionRecord record{S, 100.0, 1.0, 0.05, 0.2, type, 0};
+  std::string bytes(sizeof(record), '\0');
+  std::memcpy(bytes.data(), &record, sizeof(record));
+  return bytes;
+}
+
+bool TestBomWithoutHeaderKeepsFirstRecord() {
+  return PriceFile("vv_bom.csv",
+                   "\xEF\xBB\xBF"
+                   "100,100,1,0.05,0.2,C\n"
+                   "100,100,1,0.05,0.2,P\n") == 2;
+}
+
+bool TestBlankLinesBeforeHeaderAreSkipped() {
+  return PriceFile("vv_blank_header.csv",
+                   "\n"
+                   "  \r\n"
+                   "S,K,T,r,sigma,type\r\n"
+                   "100,100,1,0.05,0.2,Call\r\n") == 1;
+}
+
+// A first line that is a record, or starts like one, is not a header; these
+// are rejected rather than silently skipped
+bool TestFirstRecordIsNotTakenForHeader() {
+  for (const char* first_line :
+       {"inf,100,1,0.05,0.2,C\n", "nan,100,1,0.05,0.2,C\n",
+        "100,100,1,0.05,0.2,X\n"}) {
+    if (!Rejects("vv_first_record.csv",
+                 std::string(first_line) + "100,100,1,0.05,0.2,C\n")) {
+      return false;
+    }
+  }
+  return PriceFile("vv_first_record.csv",
+                   "Spot,Strike,T,r,sigma,type\n"
+                   "100,100,1,0.05,0.2,C\n") == 1;
+}
+
+bool TestAcceptsDocumentedTypeTokens() {
+  return PriceFile("vv_types.csv",
+                   "100,100,1,0.05,0.2,c\n"
+                   "100,100,1,0.05,0.2,CALL\n"
+                   "100,100,1,0.05,0.2, put \n"
+                   "100,100,1,0.05,0.2,1\n") == 4;
+}
+
+bool TestRejectsUnknownTypeToken() {
+  return Rejects("vv_bad_type.csv", "100,100,1,0.05,0.2,Cxx\n");
+}
+
+bool TestRejectsTrailingColumn() {
+  return Rejects("vv_extra_column.csv", "100,100,1,0.05,0.2,C,extra\n");
+}
+
+bool TestRejectsBinaryTypeOtherThanZeroOrOne() {
+  return PriceFile("vv_types.bin", BinaryRecord(0) + BinaryRecord(1)) == 2 &&
+         Rejects("vv_bad_type.bin", BinaryRecord(2));
+}
+
+bool TestRejectsOutOfDomainRecords() {
+  for (const char* line :
+       {"0,100,1,0.05,0.2,C\n", "100,-100,1,0.05,0.2,C\n",
+        "100,100,-1,0.05,0.2,P\n", "100,100,1,0.05,-0.2,P\n",
+        "inf,100,1,0.05,0.2,C\n", "100,100,1,nan,0.2,C\n"}) {
+    if (!Rejects("vv_domain.csv", std::string("100,100,1,0.05,0.2,C\n") +
+                                      line)) {
+      return false;
+    }
+  }
+  return Rejects("vv_domain.bin", BinaryRecord(0) + BinaryRecord(0, -100.0));
+}
+
+// Expired and zero-volatility records are priced at the discounted forward
+// intrinsic value rather than as 0/0
+bool TestZeroMaturityOrVolPricesIntrinsic() {
+  if (PriceFile("vv_intrinsic.csv",
+                "110,100,0,0.05,0.2,C\n"
+                "90,100,0,0.05,0.2,P\n"
+                "110,100,1,0.05,0,C\n"
+                "110,100,1,0.05,0,P\n"
+                "100,100,0,0.05,0.2,C\n") != 5) {
+    return false;
+  }
+  const std::vector<double> expected = {
+      10.0, 10.0, 110.0 - 100.0 * std::exp(-0.05), 0.0, 0.0};
+  std::istringstream output(ReadFile(TempPath("vv_intrinsic.csv.out.csv")));
+  std::string line;
+  std::getline(output, line);  // header
+  for (const double price : expected) {
+    if (!std::getline(output, line)) return false;
+    // Written so that a NaN price fails
+    if (!(std::abs(std::stod(line.substr(line.rfind(',') + 1)) - price) <=
+          1e-12)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Windows much smaller than a line force records to straddle chunk and
+// thread boundaries; the output must match a single-chunk run
+bool TestSmallChunksMatchSingleChunk() {
+  std::string contents = "S,K,T,r,sigma,type\n";
+  for (int i = 0; i < 50; ++i) {
+    contents += std::to_string(90 + i) + ",100,1,0.05,0.2," +
+                (i % 2 == 0 ? "C" : "P") + "\n";
+  }
+  if (PriceFile("vv_chunks.csv", contents) != 50) return false;
+  const std::string single_chunk = ReadFile(TempPath("vv_chunks.csv.out.csv"));
+  if (PriceFile("vv_chunks.csv", contents, 64) != 50) return false;
+  return ReadFile(TempPath("vv_chunks.csv.out.csv")) == single_chunk;
+}
+
+bool TestRejectsLineLongerThanChunk() {
+  return Rejects("vv_long_line.csv",
+                 "100,100,1,0.05,0.2,C\n"
+                 "100,100,1,0.05,0.2,C\n"
+                 "100.000000000000000000000000000000,100,1,0.05,0.2,C\n"
+                 "100,100,1,0.05,0.2,C\n",
+                 32);
+}
+
+}  // namespace
+
+std::vector<TestCase> BatchPricingPipelineTests() {
+  return {
+      {"BomWithoutHeaderKeepsFirstRecord",
+       TestBomWithoutHeaderKeepsFirstRecord},
+      {"BlankLinesBeforeHeaderAreSkipped",
+       TestBlankLinesBeforeHeaderAreSkipped},
+      {"FirstRecordIsNotTakenForHeader", TestFirstRecordIsNotTakenForHeader},
+      {"AcceptsDocumentedTypeTokens", TestAcceptsDocumentedTypeTokens},
+      {"RejectsUnknownTypeToken", TestRejectsUnknownTypeToken},
+      {"RejectsTrailingColumn", TestRejectsTrailingColumn},
+      {"RejectsBinaryTypeOtherThanZeroOrOne",
+       TestRejectsBinaryTypeOtherThanZeroOrOne},
+      {"RejectsOutOfDomainRecords", TestRejectsOutOfDomainRecords},
+      {"ZeroMaturityOrVolPricesIntrinsic",
+       TestZeroMaturityOrVolPricesIntrinsic},
+      {"SmallChunksMatchSingleChunk", TestSmallChunksMatchSingleChunk},
+      {"RejectsLineLongerThanChunk", TestRejectsLineLongerThanChunk},
+  };
+}
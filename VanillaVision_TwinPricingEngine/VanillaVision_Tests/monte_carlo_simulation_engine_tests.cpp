@@ -0,0 +1,110 @@
+// Tests for the single-pass Monte Carlo Greeks of MonteCarloSimulation.
+
+#include <cmath>
+
+#include "black_scholes_model.h"
+#include "monte_carlo_simulation_engine.h"
+#include "test_harness.h"
+
+namespace {
+
+constexpr double S = 100.0;
+constexpr double K = 105.0;
+constexpr double T = 0.75;
+constexpr double r = 0.03;
+constexpr double sigma = 0.25;
+constexpr int num_scenarios = 400000;
+constexpr unsigned int seed = 7;
+
+// Closed-form Black-Scholes price and Greeks
+struct AnalyticGreeks {
+  double price;
+  double delta;
+  double gamma;
+  double vega;
+  double rho;
+};
+
+double NormalCdf(const double& x) {
+  return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+double NormalPdf(const double& x) {
+  return std::exp(-0.5 * x * x) / std::sqrt(2.0 * 3.14159265358979323846);
+}
+
+AnalyticGreeks BlackScholesGreeks(const OptionType& type) {
+  const double sqrt_T = std::sqrt(T);
+  const double d1 =
+      (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * sqrt_T);
+  const double d2 = d1 - sigma * sqrt_T;
+  const double discounted_K = K * std::exp(-r * T);
+
+  AnalyticGreeks greeks;
+  greeks.gamma = NormalPdf(d1) / (S * sigma * sqrt_T);
+  greeks.vega = S * NormalPdf(d1) * sqrt_T;
+  if (type == OptionType::Call) {
+    greeks.price = BlackScholesModel::CalculateCallPrice(S, K, T, r, sigma);
+    greeks.delta = NormalCdf(d1);
+    greeks.rho = discounted_K * T * NormalCdf(d2);
+  } else {
+    greeks.price = BlackScholesModel::CalculatePutPrice(S, K, T, r, sigma);
+    greeks.delta = NormalCdf(d1) - 1.0;
+    greeks.rho = -discounted_K * T * NormalCdf(-d2);
+  }
+  return greeks;
+}
+
+// The estimate is within four of its standard errors of the exact value
+bool Agrees(const MonteCarloEstimate& estimate, const double& exact) {
+  return estimate.standard_error > 0.0 &&
+         std::abs(estimate.value - exact) <= 4.0 * estimate.standard_error;
+}
+
+bool AgreesWithBlackScholes(const MonteCarloGreeks& greeks,
+                            const OptionType& type) {
+  const AnalyticGreeks exact = BlackScholesGreeks(type);
+  return Agrees(greeks.price, exact.price) &&
+         Agrees(greeks.delta, exact.delta) &&
+         Agrees(greeks.gamma, exact.gamma) &&
+         Agrees(greeks.vega, exact.vega) && Agrees(greeks.rho, exact.rho);
+}
+
+bool TestSingleThreadedCallGreeks() {
+  const MonteCarloSimulation simulation(S, K, T, r, sigma, OptionType::Call);
+  return AgreesWithBlackScholes(
+      simulation.RunSingleThreadedGreeks(num_scenarios, seed),
+      OptionType::Call);
+}
+
+bool TestSingleThreadedPutGreeks() {
+  const MonteCarloSimulation simulation(S, K, T, r, sigma, OptionType::Put);
+  return AgreesWithBlackScholes(
+      simulation.RunSingleThreadedGreeks(num_scenarios, seed),
+      OptionType::Put);
+}
+
+bool TestMultiThreadedCallGreeks() {
+  const MonteCarloSimulation simulation(S, K, T, r, sigma, OptionType::Call);
+  return AgreesWithBlackScholes(
+      simulation.RunMultiThreadedGreeks(num_scenarios, seed, 3),
+      OptionType::Call);
+}
+
+bool TestMultiThreadedPutGreeks() {
+  const MonteCarloSimulation simulation(S, K, T, r, sigma, OptionType::Put);
+  return AgreesWithBlackScholes(
+      simulation.RunMultiThreadedGreeks(num_scenarios, seed, 3),
+      OptionType::Put);
+}
+
+}  // namespace
+
+std::vector<TestCase> MonteCarloSimulationTests() {
+  return {
+      {"SingleThreadedCallGreeks", TestSingleThreadedCallGreeks},
+      {"SingleThreadedPutGreeks", TestSingleThreadedPutGreeks},
+      {"MultiThreadedCallGreeks", TestMultiThreadedCallGreeks},
+      {"MultiThreadedPutGreeks", TestMultiThreadedPutGreeks},
+  };
+}
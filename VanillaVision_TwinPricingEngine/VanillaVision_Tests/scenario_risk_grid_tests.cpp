@@ -0,0 +1,153 @@
+// Tests for ScenarioRiskGrid against the scalar Black-Scholes model.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "black_scholes_model.h"
+#include "scenario_risk_grid.h"
+#include "test_harness.h"
+
+namespace {
+
+const std::vector<double> kSpotShocks = {-0.5, -0.2, -0.05, 0.0, 0.05, 0.3, 1.0};
+const std::vector<double> kVolShocks = {-0.1, -0.02, 0.0, 0.05, 0.4};
+
+// Calls and puts from deep in to deep out of the money
+std::vector<OptionRecord> MakeChain() {
+  std::vector<OptionRecord> chain;
+  for (const double K : {40.0, 80.0, 100.0, 125.0, 300.0}) {
+    for (const double T : {0.02, 0.5, 3.0}) {
+      chain.push_back({100.0, K, T, 0.03, 0.25, OptionType::Call});
+      chain.push_back({100.0, K, T, 0.03, 0.25, OptionType::Put});
+    }
+  }
+  return chain;
+}
+
+double ScalarPrice(const OptionRecord& option, const double& spot_shock,
+                   const double& vol_shock) {
+  const double S = option.S * (1.0 + spot_shock);
+  const double sigma = option.sigma + vol_shock;
+  return option.type == OptionType::Call
+             ? BlackScholesModel::CalculateCallPrice(S, option.K, option.T,
+                                                     option.r, sigma)
+             : BlackScholesModel::CalculatePutPrice(S, option.K, option.T,
+                                                    option.r, sigma);
+}
+
+// Discounted forward intrinsic value, the zero-volatility limit
+double IntrinsicPrice(const OptionRecord& option, const double& spot_shock) {
+  const double forward_intrinsic =
+      option.S * (1.0 + spot_shock) - option.K * std::exp(-option.r * option.T);
+  return std::max(
+      option.type == OptionType::Call ? forward_intrinsic : -forward_intrinsic,
+      0.0);
+}
+
+bool TestGridMatchesScalarBlackScholes() {
+  const std::vector<OptionRecord> chain = MakeChain();
+  ScenarioRiskGrid grid(kSpotShocks, kVolShocks);
+  grid.Compute(chain, 3);
+
+  for (std::size_t i = 0; i < chain.size(); ++i) {
+    for (std::size_t k = 0; k < kVolShocks.size(); ++k) {
+      for (std::size_t j = 0; j < kSpotShocks.size(); ++j) {
+        const double expected = ScalarPrice(chain[i], kSpotShocks[j],
+                                            kVolShocks[k]);
+        if (std::abs(grid.GetPrice(i, k, j) - expected) >
+            1e-10 * std::max(1.0, expected)) {
+          return false;
+        }
+      }
+    }
+    if (std::abs(grid.GetBasePrice(i) - ScalarPrice(chain[i], 0.0, 0.0)) >
+        1e-10) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestPnLIsZeroAtZeroShock() {
+  const std::vector<OptionRecord> chain = MakeChain();
+  ScenarioRiskGrid grid(kSpotShocks, kVolShocks);
+  grid.Compute(chain, 2);
+
+  const std::size_t zero_spot = 3;
+  const std::size_t zero_vol = 2;
+  for (std::size_t i = 0; i < chain.size(); ++i) {
+    if (grid.GetPnL(i, zero_vol, zero_spot) != 0.0) return false;
+  }
+  return true;
+}
+
+bool TestNonPositiveShockedVolPricesIntrinsic() {
+  // sigma + shock is zero or negative for the first two vol shocks
+  const std::vector<double> vol_shocks = {-0.25, -0.4, 0.0};
+  const std::vector<OptionRecord> chain = {
+      {100.0, 90.0, 1.0, 0.05, 0.25, OptionType::Call},
+      {100.0, 110.0, 1.0, 0.05, 0.25, OptionType::Put},
+      {100.0, 120.0, 1.0, 0.05, 0.25, OptionType::Call}};
+  ScenarioRiskGrid grid(kSpotShocks, vol_shocks);
+  grid.Compute(chain, 1);
+
+  for (std::size_t i = 0; i < chain.size(); ++i) {
+    for (std::size_t k = 0; k < 2; ++k) {
+      for (std::size_t j = 0; j < kSpotShocks.size(); ++j) {
+        if (std::abs(grid.GetPrice(i, k, j) -
+                     IntrinsicPrice(chain[i], kSpotShocks[j])) > 1e-12) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestExpiredOptionPricesIntrinsic() {
+  const std::vector<OptionRecord> chain = {
+      {100.0, 95.0, 0.0, 0.05, 0.25, OptionType::Call},
+      {100.0, 95.0, 0.0, 0.05, 0.25, OptionType::Put}};
+  ScenarioRiskGrid grid(kSpotShocks, kVolShocks);
+  grid.Compute(chain, 1);
+
+  for (std::size_t i = 0; i < chain.size(); ++i) {
+    if (grid.GetBasePrice(i) != IntrinsicPrice(chain[i], 0.0)) return false;
+    for (std::size_t k = 0; k < kVolShocks.size(); ++k) {
+      for (std::size_t j = 0; j < kSpotShocks.size(); ++j) {
+        if (grid.GetPrice(i, k, j) !=
+            IntrinsicPrice(chain[i], kSpotShocks[j])) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestRejectsSpotShockAtOrBelowMinusOne() {
+  for (const double shock : {-1.0, -1.5}) {
+    try {
+      ScenarioRiskGrid grid({0.0, shock}, kVolShocks);
+      return false;
+    } catch (const std::invalid_argument&) {
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+std::vector<TestCase> ScenarioRiskGridTests() {
+  return {
+      {"GridMatchesScalarBlackScholes", TestGridMatchesScalarBlackScholes},
+      {"PnLIsZeroAtZeroShock", TestPnLIsZeroAtZeroShock},
+      {"NonPositiveShockedVolPricesIntrinsic",
+       TestNonPositiveShockedVolPricesIntrinsic},
+      {"ExpiredOptionPricesIntrinsic", TestExpiredOptionPricesIntrinsic},
+      {"RejectsSpotShockAtOrBelowMinusOne",
+       TestRejectsSpotShockAtOrBelowMinusOne},
+  };
+}
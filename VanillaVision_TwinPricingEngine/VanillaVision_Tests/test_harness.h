@@ -0,0 +1,14 @@
+#pragma once
+
+#include <vector>
+
+// A named test; run returns true when the test passes
+struct TestCase {
+  const char* name;
+  bool (*run)();
+};
+
+// Test suites, one per source file
+std::vector<TestCase> MonteCarloSimulationTests();
+std::vector<TestCase> ScenarioRiskGridTests();
+std::vector<TestCase> BatchPricingPipelineTests();
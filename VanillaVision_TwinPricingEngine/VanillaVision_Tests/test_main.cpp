@@ -0,0 +1,31 @@
+// Runs every test suite. Returns a non-zero exit code if any test fails.
+
+#include <exception>
+#include <iostream>
+#include <vector>
+
+#include "test_harness.h"
+
+int main() {
+  const std::vector<std::vector<TestCase>> suites = {
+      MonteCarloSimulationTests(),
+      ScenarioRiskGridTests(),
+      BatchPricingPipelineTests(),
+  };
+
+  int failures = 0;
+  for (const auto& suite : suites) {
+    for (const TestCase& test : suite) {
+      bool passed = false;
+      try {
+        passed = test.run();
+      } catch (const std::exception& error) {
+        std::cout << "  exception: " << error.what() << '\n';
+      }
+      std::cout << (passed ? "[PASS] " : "[FAIL] ") << test.name << '\n';
+      if (!passed) ++failures;
+    }
+  }
+  std::cout << failures << " failed\n";
+  return failures == 0 ? 0 : 1;
+}
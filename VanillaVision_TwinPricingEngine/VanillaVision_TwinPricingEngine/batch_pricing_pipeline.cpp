@@ -0,0 +1,382 @@
+#include "batch_pricing_pipeline.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "black_scholes_model.h"
+#include "mapped_file.h"
+#include "monte_carlo_simulation_engine.h"
+#include "option_record.h"
+
+namespace {
+
+constexpr char kOutputHeader[] = "S,K,T,r,sigma,type,price\n";
+
+// Formatted results of one thread's share of a chunk. Each thread owns two
+// of these so one can be written while the other is filled.
+struct WorkerOutput {
+  std::string text;
+  long long num_records = 0;
+};
+
+bool IsBinaryInput(const std::string& path) {
+  return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+// Offset just past the first '\n' at or after pos, or end if there is none
+std::size_t NextLineStart(const char* data, const std::size_t& pos,
+                          const std::size_t& end) {
+  if (pos >= end) return end;
+  const void* newline = std::memchr(data + pos, '\n', end - pos);
+  return newline == nullptr
+             ? end
+             : static_cast<std::size_t>(static_cast<const char*>(newline) -
+                                        data) +
+                   1;
+}
+
+// Offset just past the last '\n' in [0, size), or 0 if there is none
+std::size_t LastLineEnd(const char* data, const std::size_t& size) {
+  for (std::size_t pos = size; pos > 0; --pos) {
+    if (data[pos - 1] == '\n') return pos;
+  }
+  return 0;
+}
+
+const char* SkipSpaces(const char* p, const char* end) {
+  while (p < end && (*p == ' ' || *p == '\t')) ++p;
+  return p;
+}
+
+// Parses one numeric field and the ',' that must follow it
+bool ParseField(const char*& p, const char* end, double& value) {
+  p = SkipSpaces(p, end);
+  if (p < end && *p == '+') ++p;
+  const auto [next, error] = std::from_chars(p, end, value);
+  if (error != std::errc()) return false;
+  p = SkipSpaces(next, end);
+  if (p == end || *p != ',') return false;
+  ++p;
+  return true;
+}
+
+bool EqualsIgnoreCase(const std::string_view& token,
+                      const std::string_view& expected) {
+  if (token.size() != expected.size()) return false;
+  for (std::size_t i = 0; i < token.size(); ++i) {
+    const char c = token[i] >= 'A' && token[i] <= 'Z'
+                       ? static_cast<char>(token[i] - 'A' + 'a')
+                       : token[i];
+    if (c != expected[i]) return false;
+  }
+  return true;
+}
+
+// The last field must be exactly C/Call or P/Put in any case, or 0/1 as in
+// the binary format; anything after it (e.g. another column) is rejected
+bool ParseType(const char* p, const char* end, OptionType& type) {
+  p = SkipSpaces(p, end);
+  while (end > p && (end[-1] == ' ' || end[-1] == '\t')) --end;
+  const std::string_view token(p, static_cast<std::size_t>(end - p));
+  if (EqualsIgnoreCase(token, "c") || EqualsIgnoreCase(token, "call") ||
+      token == "0") {
+    type = OptionType::Call;
+    return true;
+  }
+  if (EqualsIgnoreCase(token, "p") || EqualsIgnoreCase(token, "put") ||
+      token == "1") {
+    type = OptionType::Put;
+    return true;
+  }
+  return false;
+}
+
+bool ParseCsvLine(const char* p, const char* end, OptionRecord& record) {
+  return ParseField(p, end, record.S) && ParseField(p, end, record.K) &&
+         ParseField(p, end, record.T) && ParseField(p, end, record.r) &&
+         ParseField(p, end, record.sigma) && ParseType(p, end, record.type);
+}
+
+// Prices need finite inputs with S, K > 0 and T, sigma >= 0
+bool IsValidRecord(const OptionRecord& record) {
+  for (const double field :
+       {record.S, record.K, record.T, record.r, record.sigma}) {
+    if (!std::isfinite(field)) return false;
+  }
+  return record.S > 0.0 && record.K > 0.0 && record.T >= 0.0 &&
+         record.sigma >= 0.0;
+}
+
+// Line end with any trailing '\n' / '\r' removed
+const char* TrimLineEnd(const char* line, const char* line_end) {
+  while (line_end > line && (line_end[-1] == '\n' || line_end[-1] == '\r')) {
+    --line_end;
+  }
+  return line_end;
+}
+
+// Bytes to skip before the first record: a UTF-8 byte order mark, blank
+// lines, and a header line. The first non-blank line is the header only if
+// it does not parse as a record and does not start with a number, so "inf"
+// or "nan" records are kept and a malformed first record is still reported.
+std::size_t SkipCsvPreamble(const char* data, const std::size_t& size) {
+  constexpr std::string_view bom = "\xEF\xBB\xBF";
+  std::size_t pos = 0;
+  if (std::string_view(data, size).substr(0, bom.size()) == bom) {
+    pos = bom.size();
+  }
+
+  while (pos < size) {
+    const std::size_t next_line = NextLineStart(data, pos, size);
+    const char* line_end = TrimLineEnd(data + pos, data + next_line);
+    const char* first = SkipSpaces(data + pos, line_end);
+    if (first != line_end) {
+      OptionRecord record;
+      const char* field = first;
+      double value;
+      const bool is_header = !ParseCsvLine(first, line_end, record) &&
+                             !ParseField(field, line_end, value);
+      return is_header ? next_line : pos;
+    }
+    pos = next_line;
+  }
+  return pos;
+}
+
+// data holds the bytes of the file from file_offset onwards; file_offset is
+// only used to report the position of malformed records
+void ParseCsvRange(const char* data, const std::uint64_t& file_offset,
+                   const std::size_t& begin, const std::size_t& end,
+                   std::vector<OptionRecord>& records) {
+  std::size_t line_begin = begin;
+  while (line_begin < end) {
+    const std::size_t next_line = NextLineStart(data, line_begin, end);
+    const char* line = data + line_begin;
+    const char* line_end = TrimLineEnd(line, data + next_line);
+
+    if (SkipSpaces(line, line_end) != line_end) {
+      OptionRecord record;
+      if (!ParseCsvLine(line, line_end, record) || !IsValidRecord(record)) {
+        throw std::runtime_error("Malformed CSV record at byte " +
+                                 std::to_string(file_offset + line_begin));
+      }
+      records.push_back(record);
+    }
+    line_begin = next_line;
+  }
+}
+
+void ParseBinaryRange(const char* data, const std::uint64_t& file_offset,
+                      const std::size_t& begin, const std::size_t& end,
+                      std::vector<OptionRecord>& records) {
+  for (std::size_t pos = begin; pos < end; pos += sizeof(BinaryOptionRecord)) {
+    // Copy out rather than cast: the mapping gives no alignment guarantee
+    BinaryOptionRecord binary;
+    std::memcpy(&binary, data + pos, sizeof(binary));
+    if (binary.type != 0 && binary.type != 1) {
+      throw std::runtime_error("Invalid option type in binary record at byte " +
+                               std::to_string(file_offset + pos));
+    }
+    const OptionRecord record{
+        binary.S, binary.K, binary.T, binary.r, binary.sigma,
+        binary.type == 0 ? OptionType::Call : OptionType::Put};
+    if (!IsValidRecord(record)) {
+      throw std::runtime_error("Malformed binary record at byte " +
+                               std::to_string(file_offset + pos));
+    }
+    records.push_back(record);
+  }
+}
+
+// Expired or zero-volatility records are priced at the discounted forward
+// intrinsic value, as in ScenarioRiskGrid
+double PriceRecord(const OptionRecord& record,
+                   const BatchPricingConfig& config) {
+  if (record.T == 0.0 || record.sigma == 0.0) {
+    const double forward_intrinsic =
+        record.S - record.K * std::exp(-record.r * record.T);
+    return std::max(record.type == OptionType::Call ? forward_intrinsic
+                                                    : -forward_intrinsic,
+                    0.0);
+  }
+  if (config.engine == BatchEngine::MonteCarlo) {
+    const MonteCarloSimulation simulation(record.S, record.K, record.T,
+                                          record.r, record.sigma, record.type);
+    return simulation
+        .RunSingleThreadedSimulation(config.num_scenarios, config.seed)
+        .first;
+  }
+  return record.type == OptionType::Call
+             ? BlackScholesModel::CalculateCallPrice(record.S, record.K,
+                                                     record.T, record.r,
+                                                     record.sigma)
+             : BlackScholesModel::CalculatePutPrice(record.S, record.K,
+                                                    record.T, record.r,
+                                                    record.sigma);
+}
+
+// Shortest representation that reads back to the same double
+void AppendDouble(std::string& output, const double& value) {
+  char buffer[32];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  output.append(buffer, result.ptr);
+}
+
+// Parse, price and format the records in [begin, end) of the mapped window;
+// records is per-thread scratch space reused from chunk to chunk
+void ProcessRange(const char* data, const std::uint64_t& file_offset,
+                  const std::size_t& begin, const std::size_t& end,
+                  const bool& binary,
+                  const BatchPricingConfig& config,
+                  std::vector<OptionRecord>& records, WorkerOutput& output) {
+  records.clear();
+  output.text.clear();
+  if (binary) {
+    ParseBinaryRange(data, file_offset, begin, end, records);
+  } else {
+    ParseCsvRange(data, file_offset, begin, end, records);
+  }
+
+  for (const OptionRecord& record : records) {
+    const double price = PriceRecord(record, config);
+    for (const double field :
+         {record.S, record.K, record.T, record.r, record.sigma}) {
+      AppendDouble(output.text, field);
+      output.text += ',';
+    }
+    output.text += record.type == OptionType::Call ? "C," : "P,";
+    AppendDouble(output.text, price);
+    output.text += '\n';
+  }
+  output.num_records = static_cast<long long>(records.size());
+}
+
+}  // namespace
+
+BatchPricingPipeline::BatchPricingPipeline(const BatchPricingConfig& config)
+    : config_(config) {}
+
+BatchPricingResult BatchPricingPipeline::Run() const {
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  MappedFile input(config_.input_path);
+  std::ofstream output(config_.output_path, std::ios::binary);
+  if (!output) {
+    throw std::runtime_error("Cannot open " + config_.output_path);
+  }
+
+  const bool binary = IsBinaryInput(config_.input_path);
+  const std::uint64_t size = input.GetSize();
+  constexpr std::size_t record_size = sizeof(BinaryOptionRecord);
+  if (binary && size % record_size != 0) {
+    throw std::runtime_error(config_.input_path +
+                             " is not a whole number of binary records");
+  }
+
+  // Each chunk is one mapped window. Binary chunks hold whole records; CSV
+  // chunks end at the last newline in the window.
+  const std::size_t chunk_bytes =
+      binary ? std::max(config_.chunk_bytes / record_size, std::size_t{1}) *
+                   record_size
+             : std::max(config_.chunk_bytes, std::size_t{1});
+  const int num_threads = std::max(config_.num_threads, 1);
+
+  std::vector<std::vector<OptionRecord>> records(num_threads);
+  std::vector<WorkerOutput> worker_outputs[2] = {
+      std::vector<WorkerOutput>(num_threads),
+      std::vector<WorkerOutput>(num_threads)};
+  int current_buffer = 0;
+  std::vector<std::size_t> boundaries(num_threads + 1);
+  std::future<void> pending_write;
+  long long num_records = 0;
+
+  output << kOutputHeader;
+  // File positions are 64-bit; lengths within a window fit in size_t
+  std::uint64_t pos = 0;
+
+  while (pos < size) {
+    const std::size_t window_length = static_cast<std::size_t>(
+        std::min<std::uint64_t>(chunk_bytes, size - pos));
+    const char* data = input.MapWindow(pos, window_length);
+    std::size_t chunk_length = window_length;
+    if (!binary && pos + window_length < size) {
+      chunk_length = LastLineEnd(data, window_length);
+      if (chunk_length == 0) {
+        throw std::runtime_error("CSV line at byte " + std::to_string(pos) +
+                                 " is longer than the chunk size");
+      }
+    }
+    const std::size_t begin =
+        !binary && pos == 0 ? SkipCsvPreamble(data, chunk_length) : 0;
+
+    // Split the chunk into one record-aligned range per thread
+    boundaries[0] = begin;
+    for (int t = 1; t < num_threads; ++t) {
+      const std::size_t split =
+          begin + (chunk_length - begin) * t / num_threads;
+      std::size_t boundary = begin;
+      if (binary) {
+        boundary = split / record_size * record_size;
+      } else if (split > begin) {
+        boundary = NextLineStart(data, split - 1, chunk_length);
+      }
+      boundaries[t] = std::max(boundary, boundaries[t - 1]);
+    }
+    boundaries[num_threads] = chunk_length;
+
+    // Fill the idle set of outputs while the previous chunk's set is still
+    // being written
+    std::vector<WorkerOutput>& outputs = worker_outputs[current_buffer];
+    std::vector<std::future<void>> futures;
+    futures.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      futures.push_back(std::async(
+          std::launch::async, ProcessRange, data, pos, boundaries[t],
+          boundaries[t + 1], binary, std::cref(config_), std::ref(records[t]),
+          std::ref(outputs[t])));
+    }
+    for (auto& future : futures) {
+      future.get();
+    }
+    for (const WorkerOutput& worker_output : outputs) {
+      num_records += worker_output.num_records;
+    }
+
+    // Write the per-thread outputs in order, without gathering them first
+    if (pending_write.valid()) pending_write.get();
+    pending_write = std::async(std::launch::async, [&output, &outputs] {
+      for (const WorkerOutput& worker_output : outputs) {
+        output.write(worker_output.text.data(),
+                     static_cast<std::streamsize>(worker_output.text.size()));
+      }
+    });
+
+    pos += chunk_length;
+    current_buffer = 1 - current_buffer;
+  }
+
+  if (pending_write.valid()) pending_write.get();
+  output.flush();
+  if (!output) {
+    throw std::runtime_error("Cannot write " + config_.output_path);
+  }
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  const std::chrono::duration<double> elapsed = end - start;
+
+  BatchPricingResult result;
+  result.num_records = num_records;
+  result.runtime_ms = elapsed.count() * 1000;
+  result.records_per_sec =
+      elapsed.count() > 0.0 ? num_records / elapsed.count() : 0.0;
+  return result;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "pricing_common.h"
+
+enum class BatchEngine { BlackScholes, MonteCarlo };
+
+// Fixed-size record of a binary chain file; type is 0 for a call, 1 for a put
+struct BinaryOptionRecord {
+  double S;
+  double K;
+  double T;
+  double r;
+  double sigma;
+  std::int32_t type;
+  std::int32_t reserved;
+};
+
+struct BatchPricingConfig {
+  std::string input_path;   // .bin for BinaryOptionRecords, otherwise CSV
+  std::string output_path;  // CSV of S,K,T,r,sigma,type,price
+  BatchEngine engine = BatchEngine::BlackScholes;
+  int num_scenarios = 10000;  // Monte Carlo engine only
+  unsigned int seed = 42;     // Monte Carlo engine only
+  int num_threads = DefaultThreadCount();
+  std::size_t chunk_bytes = 8 << 20;  // Input bytes priced per chunk
+};
+
+struct BatchPricingResult {
+  long long num_records = 0;
+  double runtime_ms = 0.0;
+  double records_per_sec = 0.0;
+};
+
+// Streams a chain file through the pricers: the input is memory-mapped and
+// walked in fixed-size chunks, each chunk is parsed and priced in parallel,
+// and the results are written through two output buffers so that writing
+// one chunk overlaps with pricing the next. Memory use is bounded by the
+// chunk size, not the file size.
+class BatchPricingPipeline {
+ private:
+  BatchPricingConfig config_;
+
+ public:
+  explicit BatchPricingPipeline(const BatchPricingConfig& config);
+  BatchPricingResult Run() const;
+};
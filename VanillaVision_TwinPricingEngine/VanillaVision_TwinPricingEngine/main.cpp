@@ -1,12 +1,97 @@
 // This file contains the 'main' function.
 // Program execution begins and ends here.
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "batch_pricing_pipeline.h"
 #include "black_scholes_model.h"
 #include "monte_carlo_simulation_engine.h"
+#include "option_record.h"
+#include "scenario_risk_grid.h"
+
+void PrintBatchUsage(const char* program) {
+  std::cerr << "Usage: " << program
+            << " --batch INPUT(.csv|.bin) OUTPUT.csv [--engine bs|mc]"
+               " [--scenarios N] [--threads N] [--chunk-mb N]\n";
+}
+
+// Parses a strictly positive integer option value
+bool ParsePositive(const std::string& value, int& result) {
+  const char* end = value.data() + value.size();
+  const auto [next, error] = std::from_chars(value.data(), end, result);
+  return error == std::errc() && next == end && result > 0;
+}
+
+// Batch mode: price every record of a chain file and write the results to
+// an output file instead of running the built-in demonstration.
+int RunBatchMode(int argc, char** argv) {
+  if (argc < 4) {
+    PrintBatchUsage(argv[0]);
+    return 1;
+  }
+
+  BatchPricingConfig config;
+  config.input_path = argv[2];
+  config.output_path = argv[3];
+  for (int i = 4; i < argc; i += 2) {
+    const std::string option = argv[i];
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << option << '\n';
+      PrintBatchUsage(argv[0]);
+      return 1;
+    }
+    const std::string value = argv[i + 1];
+
+    bool valid = true;
+    int number = 0;
+    if (option == "--engine") {
+      valid = value == "bs" || value == "mc";
+      config.engine =
+          value == "mc" ? BatchEngine::MonteCarlo : BatchEngine::BlackScholes;
+    } else if (option == "--scenarios") {
+      valid = ParsePositive(value, config.num_scenarios);
+    } else if (option == "--threads") {
+      valid = ParsePositive(value, config.num_threads);
+    } else if (option == "--chunk-mb") {
+      valid = ParsePositive(value, number);
+      config.chunk_bytes = static_cast<std::size_t>(number) << 20;
+    } else {
+      std::cerr << "Unknown option " << option << '\n';
+      PrintBatchUsage(argv[0]);
+      return 1;
+    }
+    if (!valid) {
+      std::cerr << "Invalid value " << value << " for " << option << '\n';
+      PrintBatchUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  try {
+    const BatchPricingResult result = BatchPricingPipeline(config).Run();
+    std::cout << "Priced " << result.num_records << " records in "
+              << result.runtime_ms << "ms; " << result.records_per_sec
+              << " records/sec\n";
+  } catch (const std::exception& error) {
+    std::cerr << "Batch pricing failed: " << error.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1 && std::string(argv[1]) == "--batch") {
+    return RunBatchMode(argc, argv);
+  }
 
-int main() {
   std::cout << "Hello World!\n";
 
   constexpr double S = 100.0;    // Spot price
@@ -59,6 +144,71 @@ int main() {
                "single-threaded simulation: "
             << difference_single << '\n';
 
+  // Price and Greeks in a single multi-threaded pass over the paths
+  const MonteCarloGreeks call_greeks =
+      call_simulation.RunMultiThreadedGreeks(num_scenarios, seed);
+
+  std::cout << '\n'
+            << "Runtime (Price and Greeks in one pass) = "
+            << call_greeks.runtime_ms << "ms\n";
+  const std::pair<const char*, MonteCarloEstimate> greek_rows[] = {
+      {"price", call_greeks.price}, {"delta", call_greeks.delta},
+      {"gamma", call_greeks.gamma}, {"vega", call_greeks.vega},
+      {"rho", call_greeks.rho}};
+  for (const auto& [name, estimate] : greek_rows) {
+    std::cout << "  " << name << " = " << estimate.value
+              << " (std. error " << estimate.standard_error << ")\n";
+  }
+
+  // Spot/vol stress grid: 41 spot shocks (-20%..+20%) by 21 vol shocks
+  // (-10..+10 vol points) over a small chain of calls and puts
+  std::vector<double> spot_shocks;
+  for (int i = -20; i <= 20; ++i) spot_shocks.push_back(i * 0.01);
+  std::vector<double> vol_shocks;
+  for (int i = -10; i <= 10; ++i) vol_shocks.push_back(i * 0.01);
+
+  std::vector<OptionRecord> chain;
+  for (int i = 0; i < 1000; ++i) {
+    chain.push_back({S, 80.0 + 0.04 * i, T, r, sigma,
+                     i % 2 == 0 ? OptionType::Call : OptionType::Put});
+  }
+
+  ScenarioRiskGrid risk_grid(spot_shocks, vol_shocks);
+  risk_grid.Reserve(chain.size());
+  const auto grid_start = std::chrono::high_resolution_clock::now();
+  risk_grid.Compute(chain);
+  const std::chrono::duration<double> grid_elapsed =
+      std::chrono::high_resolution_clock::now() - grid_start;
+
+  std::cout << '\n'
+            << "Runtime (Scenario grid " << spot_shocks.size() << "x"
+            << vol_shocks.size() << " for " << chain.size()
+            << " options) = " << grid_elapsed.count() * 1000 << "ms\n";
+
+  // Compare the grid against the scalar Black-Scholes prices
+  double max_grid_difference = 0.0;
+  for (std::size_t i = 0; i < chain.size(); ++i) {
+    const OptionRecord& option = chain[i];
+    for (std::size_t k = 0; k < vol_shocks.size(); ++k) {
+      for (std::size_t j = 0; j < spot_shocks.size(); ++j) {
+        const double shocked_S = option.S * (1.0 + spot_shocks[j]);
+        const double shocked_sigma = option.sigma + vol_shocks[k];
+        const double scalar_price =
+            option.type == OptionType::Call
+                ? BlackScholesModel::CalculateCallPrice(
+                      shocked_S, option.K, option.T, option.r, shocked_sigma)
+                : BlackScholesModel::CalculatePutPrice(
+                      shocked_S, option.K, option.T, option.r, shocked_sigma);
+        max_grid_difference =
+            std::max(max_grid_difference,
+                     std::abs(scalar_price - risk_grid.GetPrice(i, k, j)));
+      }
+    }
+  }
+  std::cout << "Max difference between scenario grid and scalar "
+               "Black-Scholes: "
+            << max_grid_difference << '\n';
+
   //// Create MonteCarloSimulation for Put option
   // MonteCarloSimulation putSimulation(S, K, T, r, sigma, OptionType::Put);
 
@@ -0,0 +1,139 @@
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+  file_handle_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                             nullptr, OPEN_EXISTING,
+                             FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file_handle_ == INVALID_HANDLE_VALUE) {
+    file_handle_ = nullptr;
+    throw std::runtime_error("Cannot open " + path);
+  }
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file_handle_, &file_size)) {
+    CloseHandle(file_handle_);
+    throw std::runtime_error("Cannot read the size of " + path);
+  }
+  size_ = static_cast<std::uint64_t>(file_size.QuadPart);
+  if (size_ == 0) return;  // Empty files cannot be mapped
+
+  mapping_handle_ =
+      CreateFileMappingA(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_handle_ == nullptr) {
+    CloseHandle(file_handle_);
+    throw std::runtime_error("Cannot map " + path);
+  }
+}
+
+MappedFile::~MappedFile() {
+  Unmap();
+  if (mapping_handle_ != nullptr) CloseHandle(mapping_handle_);
+  if (file_handle_ != nullptr) CloseHandle(file_handle_);
+}
+
+void MappedFile::Unmap() {
+  if (view_ != nullptr) UnmapViewOfFile(view_);
+  view_ = nullptr;
+  view_length_ = 0;
+}
+
+const char* MappedFile::MapWindow(const std::uint64_t& offset,
+                                  const std::size_t& length) {
+  Unmap();
+  if (length == 0) return nullptr;
+
+  // View offsets must be multiples of the allocation granularity
+  SYSTEM_INFO system_info;
+  GetSystemInfo(&system_info);
+  const std::uint64_t granularity = system_info.dwAllocationGranularity;
+  const std::uint64_t view_offset = offset / granularity * granularity;
+  // Less than the granularity, so it fits in size_t
+  const std::size_t alignment = static_cast<std::size_t>(offset - view_offset);
+
+  view_length_ = alignment + length;
+  view_ = static_cast<char*>(MapViewOfFile(
+      mapping_handle_, FILE_MAP_READ, static_cast<DWORD>(view_offset >> 32),
+      static_cast<DWORD>(view_offset & 0xFFFFFFFFu), view_length_));
+  if (view_ == nullptr) {
+    view_length_ = 0;
+    throw std::runtime_error("Cannot map file window at byte " +
+                             std::to_string(offset));
+  }
+  return view_ + alignment;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+  file_descriptor_ = open(path.c_str(), O_RDONLY);
+  if (file_descriptor_ < 0) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+
+  struct stat file_status;
+  if (fstat(file_descriptor_, &file_status) != 0) {
+    close(file_descriptor_);
+    throw std::runtime_error("Cannot read the size of " + path);
+  }
+  size_ = static_cast<std::uint64_t>(file_status.st_size);
+}
+
+MappedFile::~MappedFile() {
+  Unmap();
+  if (file_descriptor_ >= 0) close(file_descriptor_);
+}
+
+void MappedFile::Unmap() {
+  if (view_ != nullptr) munmap(view_, view_length_);
+  view_ = nullptr;
+  view_length_ = 0;
+}
+
+const char* MappedFile::MapWindow(const std::uint64_t& offset,
+                                  const std::size_t& length) {
+  Unmap();
+  if (length == 0) return nullptr;
+
+  // mmap offsets must be multiples of the page size
+  const std::uint64_t page_size =
+      static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+  const std::uint64_t view_offset = offset / page_size * page_size;
+  // Less than the page size, so it fits in size_t
+  const std::size_t alignment = static_cast<std::size_t>(offset - view_offset);
+
+  view_length_ = alignment + length;
+  void* mapping = mmap(nullptr, view_length_, PROT_READ, MAP_PRIVATE,
+                       file_descriptor_, static_cast<off_t>(view_offset));
+  if (mapping == MAP_FAILED) {
+    view_length_ = 0;
+    throw std::runtime_error("Cannot map file window at byte " +
+                             std::to_string(offset));
+  }
+  view_ = static_cast<char*>(mapping);
+  madvise(view_, view_length_, MADV_SEQUENTIAL);
+  return view_ + alignment;
+}
+
+#endif
+
+std::uint64_t MappedFile::GetSize() const { return size_; }
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a file, one window at a time. Mapping a new
+// window unmaps the previous one, so resident memory and address space are
+// bounded by the window size rather than the file size. Sizes and offsets
+// within the file are 64-bit so files larger than the address space work.
+class MappedFile {
+ private:
+  std::uint64_t size_ = 0;
+  char* view_ = nullptr;  // Start of the mapped, granularity-aligned region
+  std::size_t view_length_ = 0;
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#else
+  int file_descriptor_ = -1;
+#endif
+
+  void Unmap();
+
+ public:
+  explicit MappedFile(const std::string& path);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  std::uint64_t GetSize() const;
+
+  // Maps [offset, offset + length) in place of the previous window and
+  // returns a pointer to the byte at offset. The pointer is valid until the
+  // next call or until the file is destroyed.
+  const char* MapWindow(const std::uint64_t& offset, const std::size_t& length);
+};
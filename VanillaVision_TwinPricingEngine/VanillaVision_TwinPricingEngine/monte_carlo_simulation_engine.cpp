@@ -1,16 +1,128 @@
 
 #include "monte_carlo_simulation_engine.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <functional>
 #include <future>
 #include <numeric>
 #include <random>
-#include <thread>
 #include <vector>
 
 #include "pay_off.h"
 #include "vanilla_option.h"
 
+namespace {
+
+// Running sums of price, delta, gamma, vega and rho samples (in that order)
+struct GreekSums {
+  long long count = 0;
+  std::array<double, 5> sum{};
+  std::array<double, 5> sum_sq{};
+
+  void Add(const std::array<double, 5>& sample) {
+    ++count;
+    for (std::size_t j = 0; j < sample.size(); ++j) {
+      sum[j] += sample[j];
+      sum_sq[j] += sample[j] * sample[j];
+    }
+  }
+
+  void Merge(const GreekSums& other) {
+    count += other.count;
+    for (std::size_t j = 0; j < sum.size(); ++j) {
+      sum[j] += other.sum[j];
+      sum_sq[j] += other.sum_sq[j];
+    }
+  }
+};
+
+// Simulate num_scenarios terminal prices and accumulate the discounted payoff
+// together with its pathwise / likelihood-ratio sensitivities.
+GreekSums AccumulateGreeks(const VanillaOption& option, OptionType optionType,
+                           const int& num_scenarios, const unsigned int& seed) {
+  const double S = option.GetS();
+  const double K = option.GetK();
+  const double T = option.GetT();
+  const double r = option.Getr();
+  const double sigma = option.Getsigma();
+
+  const double sqrt_T = std::sqrt(T);
+  const double drift = (r - 0.5 * sigma * sigma) * T;
+  const double vol = sigma * sqrt_T;
+  const double discount = std::exp(-r * T);
+
+  std::mt19937 generator(seed);
+  std::normal_distribution<double> nd(0.0, 1.0);
+  GreekSums sums;
+
+  for (int i = 0; i < num_scenarios; ++i) {
+    const double epsilon = nd(generator);
+    const double S_T = S * std::exp(drift + vol * epsilon);
+
+    const double payoff = optionType == OptionType::Call
+                              ? PayOff::PayOffCall(S_T, K)
+                              : PayOff::PayOffPut(K, S_T);
+    // Derivative of the payoff with respect to S_T
+    double payoff_slope = 0.0;
+    if (optionType == OptionType::Call && S_T > K) payoff_slope = 1.0;
+    if (optionType == OptionType::Put && S_T < K) payoff_slope = -1.0;
+
+    // dS_T/dS = S_T/S, dS_T/dsigma = S_T(sqrt(T)Z - sigma T), dS_T/dr = S_T T.
+    // Gamma differentiates the pathwise delta with the likelihood-ratio score
+    // Z/(S sigma sqrt(T)) of the terminal density.
+    const double delta = discount * payoff_slope * S_T / S;
+    const double gamma = delta / S * (epsilon / vol - 1.0);
+    const double vega =
+        discount * payoff_slope * S_T * (sqrt_T * epsilon - sigma * T);
+    const double rho = discount * T * (payoff_slope * S_T - payoff);
+
+    sums.Add({discount * payoff, delta, gamma, vega, rho});
+  }
+  return sums;
+}
+
+MonteCarloEstimate MakeEstimate(const GreekSums& sums, const std::size_t& j) {
+  const double n = static_cast<double>(sums.count);
+  const double mean = sums.sum[j] / n;
+  const double variance =
+      sums.count > 1 ? std::max(sums.sum_sq[j] / n - mean * mean, 0.0) *
+                           n / (n - 1.0)
+                     : 0.0;
+  return {mean, std::sqrt(variance / n)};
+}
+
+MonteCarloGreeks MakeGreeks(const GreekSums& sums) {
+  MonteCarloGreeks greeks;
+  greeks.price = MakeEstimate(sums, 0);
+  greeks.delta = MakeEstimate(sums, 1);
+  greeks.gamma = MakeEstimate(sums, 2);
+  greeks.vega = MakeEstimate(sums, 3);
+  greeks.rho = MakeEstimate(sums, 4);
+  return greeks;
+}
+
+}  // namespace
+
+// Threads actually used: at least one, and never more than the scenarios so
+// that no thread is left with an empty (0/0) average
+int MonteCarloSimulation::ClampThreadCount(const int& num_scenarios,
+                                           const int& num_threads) {
+  return std::clamp(num_threads, 1, std::max(num_scenarios, 1));
+}
+
+// Scenarios handled by thread_index; the last thread picks up the remainder
+int MonteCarloSimulation::ScenariosForThread(const int& num_scenarios,
+                                             const int& num_threads,
+                                             const int& thread_index) {
+  const int num_scenarios_per_thread = num_scenarios / num_threads;
+  return thread_index == num_threads - 1
+             ? num_scenarios - num_scenarios_per_thread * (num_threads - 1)
+             : num_scenarios_per_thread;
+}
+
 // parametrized Constructor
 MonteCarloSimulation::MonteCarloSimulation(const double& S, const double& K,
                                            const double& T, const double& r,
@@ -52,33 +164,92 @@ std::pair<double, double> MonteCarloSimulation::RunSingleThreadedSimulation(
   return {averagePrice, elapsed.count() * 1000};
 }
 
-// Multi-threaded Monte Carlo simulation
+// Multi-threaded Monte Carlo simulation on all hardware threads
 std::pair<double, double> MonteCarloSimulation::RunMultiThreadedSimulation(
     const int& num_scenarios, const unsigned int& seed) {
+  return RunMultiThreadedSimulation(num_scenarios, seed,
+                                    DefaultThreadCount());
+}
+
+// Multi-threaded Monte Carlo simulation. Each thread draws from its own seed
+// so adding threads adds independent scenarios rather than repeating them.
+std::pair<double, double> MonteCarloSimulation::RunMultiThreadedSimulation(
+    const int& num_scenarios, const unsigned int& seed,
+    const int& num_threads) {
   const auto start = std::chrono::high_resolution_clock::now();
 
+  const int threads = ClampThreadCount(num_scenarios, num_threads);
   std::vector<std::future<std::pair<double, double>>> futures;
-  const int num_threads = std::thread::hardware_concurrency();
-  const int num_scenarios_per_thread = num_scenarios / num_threads;
+  std::vector<int> thread_scenarios(threads);
 
-  futures.reserve(num_threads);
-  for (int i = 0; i < num_threads; ++i) {
+  futures.reserve(threads);
+  for (int i = 0; i < threads; ++i) {
+    thread_scenarios[i] = ScenariosForThread(num_scenarios, threads, i);
     futures.push_back(std::async(
         std::launch::async, &MonteCarloSimulation::RunSingleThreadedSimulation,
-        this, num_scenarios_per_thread, seed));
+        this, thread_scenarios[i], seed + i));
   }
 
-  std::vector<double> all_prices;
-  for (auto& future : futures) {
-    const auto prices = future.get();
-    all_prices.emplace_back(prices.first);
+  // Weight each thread's average by its share of the scenarios
+  double weighted_price_sum = 0.0;
+  for (int i = 0; i < threads; ++i) {
+    const auto prices = futures[i].get();
+    weighted_price_sum += prices.first * thread_scenarios[i];
   }
 
-  const double average_discounted_price =
-      std::accumulate(all_prices.begin(), all_prices.end(), 0.0) / num_threads;
+  const double average_discounted_price = weighted_price_sum / num_scenarios;
 
   const auto end = std::chrono::high_resolution_clock::now();
   const std::chrono::duration<double> elapsed = end - start;
 
   return {average_discounted_price, elapsed.count() * 1000};
-}
\ No newline at end of file
+}
+
+// Single-threaded price and Greeks in one pass over the paths
+MonteCarloGreeks MonteCarloSimulation::RunSingleThreadedGreeks(
+    const int& num_scenarios, const unsigned int& seed) const {
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  MonteCarloGreeks greeks =
+      MakeGreeks(AccumulateGreeks(option_, optionType_, num_scenarios, seed));
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  const std::chrono::duration<double> elapsed = end - start;
+  greeks.runtime_ms = elapsed.count() * 1000;
+  return greeks;
+}
+
+// Multi-threaded price and Greeks on all hardware threads
+MonteCarloGreeks MonteCarloSimulation::RunMultiThreadedGreeks(
+    const int& num_scenarios, const unsigned int& seed) const {
+  return RunMultiThreadedGreeks(num_scenarios, seed, DefaultThreadCount());
+}
+
+// Multi-threaded price and Greeks in one pass over the paths. Each thread
+// draws from its own seed so the pooled standard errors stay valid.
+MonteCarloGreeks MonteCarloSimulation::RunMultiThreadedGreeks(
+    const int& num_scenarios, const unsigned int& seed,
+    const int& num_threads) const {
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  const int threads = ClampThreadCount(num_scenarios, num_threads);
+  std::vector<std::future<GreekSums>> futures;
+
+  futures.reserve(threads);
+  for (int i = 0; i < threads; ++i) {
+    futures.push_back(std::async(
+        std::launch::async, AccumulateGreeks, std::cref(option_), optionType_,
+        ScenariosForThread(num_scenarios, threads, i), seed + i));
+  }
+
+  GreekSums sums;
+  for (auto& future : futures) {
+    sums.Merge(future.get());
+  }
+  MonteCarloGreeks greeks = MakeGreeks(sums);
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  const std::chrono::duration<double> elapsed = end - start;
+  greeks.runtime_ms = elapsed.count() * 1000;
+  return greeks;
+}
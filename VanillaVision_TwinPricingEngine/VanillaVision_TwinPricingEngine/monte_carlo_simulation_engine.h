@@ -2,15 +2,36 @@
 
 #include <utility>
 
+#include "pricing_common.h"
 #include "vanilla_option.h"
 
-enum class OptionType { Call, Put };
+// Monte Carlo estimate together with its standard error
+struct MonteCarloEstimate {
+  double value = 0.0;
+  double standard_error = 0.0;
+};
+
+// Price and sensitivities estimated in a single pass over the paths
+struct MonteCarloGreeks {
+  MonteCarloEstimate price;
+  MonteCarloEstimate delta;  // Pathwise
+  MonteCarloEstimate gamma;  // Likelihood-ratio applied to pathwise delta
+  MonteCarloEstimate vega;   // Pathwise
+  MonteCarloEstimate rho;    // Pathwise
+  double runtime_ms = 0.0;
+};
 
 class MonteCarloSimulation {
  private:
   VanillaOption option_;
   OptionType optionType_;
 
+  static int ClampThreadCount(const int& num_scenarios,
+                              const int& num_threads);
+  static int ScenariosForThread(const int& num_scenarios,
+                                const int& num_threads,
+                                const int& thread_index);
+
  public:
   MonteCarloSimulation(const double& S, const double& K, const double& T,
                        const double& r, const double& sigma,
@@ -19,4 +40,14 @@ class MonteCarloSimulation {
       const int& num_scenarios, const unsigned int& seed) const;
   std::pair<double, double> RunMultiThreadedSimulation(
       const int& num_scenarios, const unsigned int& seed);
+  std::pair<double, double> RunMultiThreadedSimulation(
+      const int& num_scenarios, const unsigned int& seed,
+      const int& num_threads);
+  MonteCarloGreeks RunSingleThreadedGreeks(const int& num_scenarios,
+                                           const unsigned int& seed) const;
+  MonteCarloGreeks RunMultiThreadedGreeks(const int& num_scenarios,
+                                          const unsigned int& seed) const;
+  MonteCarloGreeks RunMultiThreadedGreeks(const int& num_scenarios,
+                                          const unsigned int& seed,
+                                          const int& num_threads) const;
 };
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "pricing_common.h"
+
+// Plain description of one option in a chain
+struct OptionRecord {
+  double S;      // Underlying asset price
+  double K;      // Strike price
+  double T;      // Maturity time; Expiry date
+  double r;      // Risk-free interest rate
+  double sigma;  // Volatility of the underlying asset
+  OptionType type;
+};
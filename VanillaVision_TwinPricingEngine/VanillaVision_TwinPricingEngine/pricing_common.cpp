@@ -0,0 +1,8 @@
+#include "pricing_common.h"
+
+#include <algorithm>
+#include <thread>
+
+int DefaultThreadCount() {
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
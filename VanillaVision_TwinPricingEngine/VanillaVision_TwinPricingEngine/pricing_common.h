@@ -0,0 +1,6 @@
+#pragma once
+
+enum class OptionType { Call, Put };
+
+// Number of worker threads used when the caller does not choose one
+int DefaultThreadCount();
@@ -0,0 +1,273 @@
+#include "scenario_risk_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+constexpr double kInvSqrt2 = 0.70710678118654752440;
+
+// Option inputs that do not depend on the shocks
+struct OptionIntermediates {
+  double S;
+  double log_moneyness;  // log(S/K)
+  double sqrt_T;
+  double rT;
+  double discounted_K;  // K exp(-rT)
+};
+
+// Inputs shared by every spot shock at one volatility
+struct VolIntermediates {
+  double vol_sqrt_T;  // sigma sqrt(T)
+  double inv_vol_sqrt_T;
+  double drift;  // (r + sigma^2 / 2) T
+};
+
+OptionIntermediates MakeOptionIntermediates(const OptionRecord& option) {
+  const double sqrt_T = std::sqrt(option.T);
+  return {option.S, std::log(option.S / option.K), sqrt_T, option.r * option.T,
+          option.K * std::exp(-option.r * option.T)};
+}
+
+VolIntermediates MakeVolIntermediates(const OptionIntermediates& option,
+                                      const double& sigma) {
+  const double vol_sqrt_T = sigma * option.sqrt_T;
+  return {vol_sqrt_T, 1.0 / vol_sqrt_T,
+          option.rT + 0.5 * vol_sqrt_T * vol_sqrt_T};
+}
+
+// Polynomial in u in [-1, 1] approximating f(u) = log(erfc(z) / t) + z^2
+// with t = 2 / (2 + z) and u linear in t over z in [0, kMaxZ]; highest
+// power first for Horner evaluation
+constexpr double kErfcCoefficients[] = {
+    5.064066499471665e-10,   -3.3774995245039466e-09, 2.722663339227438e-09,
+    2.613087417557836e-08,   -6.890877557452768e-08,  -4.571411409415305e-08,
+    4.918240847473499e-07,   -5.822255388920895e-07,  -1.8054758129437688e-06,
+    6.203415711070193e-06,   3.786633158142649e-07,   -3.533778157702728e-05,
+    4.83254857385873e-05,    0.00013804517355637814,  -0.0004601361352541744,
+    -0.0003170123281606152,  0.0033554214356863454,   -0.0006572509176273611,
+    -0.027953060099522233,   0.013626166489121395,    0.5604713436267975,
+    -0.5482211025100724};
+constexpr std::size_t kNumErfcCoefficients =
+    sizeof(kErfcCoefficients) / sizeof(kErfcCoefficients[0]);
+// Beyond z = 9 the CDF is within 1e-36 of 0 or 1
+constexpr double kMaxZ = 9.0;
+constexpr double kMinT = 2.0 / (2.0 + kMaxZ);
+
+// exp(y) for y in roughly [-700, 700]. Cody-Waite reduction by ln 2 and a
+// degree-13 Taylor polynomial; the power of two is built from the exponent
+// bits, so there are no calls or branches.
+inline double Exp(const double& y) {
+  constexpr double log2e = 1.4426950408889634;
+  constexpr double ln2_hi = 0.6931471803691238;
+  constexpr double ln2_lo = 1.9082149292705877e-10;
+  // Adding 1.5 * 2^52 rounds to an integer held in the low mantissa bits
+  constexpr double round_shift = 6755399441055744.0;
+  const double shifted = y * log2e + round_shift;
+  std::uint64_t k_bits;
+  std::memcpy(&k_bits, &shifted, sizeof(k_bits));
+  const double k = shifted - round_shift;
+  const double x = (y - k * ln2_hi) - k * ln2_lo;
+
+  double p = 1.0 / 6227020800.0;
+  p = p * x + 1.0 / 479001600.0;
+  p = p * x + 1.0 / 39916800.0;
+  p = p * x + 1.0 / 3628800.0;
+  p = p * x + 1.0 / 362880.0;
+  p = p * x + 1.0 / 40320.0;
+  p = p * x + 1.0 / 5040.0;
+  p = p * x + 1.0 / 720.0;
+  p = p * x + 1.0 / 120.0;
+  p = p * x + 1.0 / 24.0;
+  p = p * x + 1.0 / 6.0;
+  p = p * x + 0.5;
+  p = p * x + 1.0;
+  p = p * x + 1.0;
+
+  const std::uint64_t scale_bits = (k_bits + 1023) << 52;
+  double scale;
+  std::memcpy(&scale, &scale_bits, sizeof(scale));
+  return p * scale;
+}
+
+// Horner evaluation of kErfcCoefficients, unrolled at compile time so the
+// callers' loops have no inner loop
+template <std::size_t... K>
+inline double ErfcPolynomial(const double& u, std::index_sequence<K...>) {
+  double f = 0.0;
+  ((f = f * u + kErfcCoefficients[K]), ...);
+  return f;
+}
+
+// Standard normal CDF without calls or data-dependent branches, so a loop
+// over it vectorises, unlike a per-element std::erf call
+inline double NormalCdf(const double& x) {
+  // t = 2 / (2 + z) lies in (0, 1], so max(t, kMinT) can be taken with
+  // arithmetic instead of a compare; z is then recovered from t.
+  const double t_unclamped = 2.0 / (2.0 + std::abs(x) * kInvSqrt2);
+  const double t =
+      0.5 * (t_unclamped + kMinT + std::abs(t_unclamped - kMinT));
+  const double z = 2.0 / t - 2.0;
+  const double u = (t - kMinT) * (2.0 / (1.0 - kMinT)) - 1.0;
+  const double f =
+      ErfcPolynomial(u, std::make_index_sequence<kNumErfcCoefficients>());
+  // erfc(z) = t exp(-z^2 + f), and N(x) is erfc(z) / 2 for x < 0 and
+  // 1 - erfc(z) / 2 otherwise. The leading term is exactly 0 or 1, so the
+  // lower tail keeps its relative accuracy without a compare.
+  const double half_erfc = 0.5 * t * Exp(f - z * z);
+  return (0.5 + std::copysign(0.5, x)) - std::copysign(half_erfc, x);
+}
+
+// Black-Scholes prices of one volatility row. Puts use N(-d) directly
+// rather than 1 - N(d) to keep their relative accuracy.
+void PriceRow(const OptionIntermediates& option, const VolIntermediates& vol,
+              const OptionType& type, const double* spot_factors,
+              const double* log_spot_factors, const std::size_t& num_spots,
+              double* out) {
+  const double sign = type == OptionType::Call ? 1.0 : -1.0;
+  for (std::size_t j = 0; j < num_spots; ++j) {
+    const double d1 =
+        (option.log_moneyness + log_spot_factors[j] + vol.drift) *
+        vol.inv_vol_sqrt_T;
+    const double d2 = d1 - vol.vol_sqrt_T;
+    out[j] = sign * (option.S * spot_factors[j] * NormalCdf(sign * d1) -
+                     option.discounted_K * NormalCdf(sign * d2));
+  }
+}
+
+// Zero-volatility (or expired) limit: discounted forward intrinsic value
+void PriceIntrinsicRow(const OptionIntermediates& option,
+                       const OptionType& type, const double* spot_factors,
+                       const std::size_t& num_spots, double* out) {
+  const double sign = type == OptionType::Call ? 1.0 : -1.0;
+  for (std::size_t j = 0; j < num_spots; ++j) {
+    out[j] = std::max(
+        sign * (option.S * spot_factors[j] - option.discounted_K), 0.0);
+  }
+}
+
+}  // namespace
+
+ScenarioRiskGrid::ScenarioRiskGrid(const std::vector<double>& spot_shocks,
+                                   const std::vector<double>& vol_shocks)
+    : spot_shocks_(spot_shocks), vol_shocks_(vol_shocks) {
+  spot_factors_.reserve(spot_shocks_.size());
+  log_spot_factors_.reserve(spot_shocks_.size());
+  for (const double shock : spot_shocks_) {
+    if (shock <= -1.0) {
+      throw std::invalid_argument("Spot shocks must be greater than -100%");
+    }
+    spot_factors_.push_back(1.0 + shock);
+    log_spot_factors_.push_back(std::log1p(shock));
+  }
+}
+
+// Pre-size the result buffers so later Compute calls do not allocate
+void ScenarioRiskGrid::Reserve(const std::size_t& num_options) {
+  prices_.reserve(num_options * vol_shocks_.size() * spot_shocks_.size());
+  base_prices_.reserve(num_options);
+}
+
+void ScenarioRiskGrid::Compute(const std::vector<OptionRecord>& chain) {
+  Compute(chain, DefaultThreadCount());
+}
+
+// Options are split into contiguous blocks, one per thread; each block
+// writes to its own slice of the result buffer.
+void ScenarioRiskGrid::Compute(const std::vector<OptionRecord>& chain,
+                               const int& num_threads) {
+  num_options_ = chain.size();
+  prices_.resize(num_options_ * vol_shocks_.size() * spot_shocks_.size());
+  base_prices_.resize(num_options_);
+
+  const std::size_t num_blocks = std::min<std::size_t>(
+      std::max(num_threads, 1), std::max<std::size_t>(num_options_, 1));
+  const std::size_t block_size = num_options_ / num_blocks;
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(num_blocks);
+  for (std::size_t i = 0; i < num_blocks; ++i) {
+    // The last block picks up the remainder of the division
+    const std::size_t begin = i * block_size;
+    const std::size_t end =
+        i == num_blocks - 1 ? num_options_ : begin + block_size;
+    futures.push_back(std::async(std::launch::async,
+                                 &ScenarioRiskGrid::ComputeRange, this,
+                                 std::cref(chain), begin, end));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
+void ScenarioRiskGrid::ComputeRange(const std::vector<OptionRecord>& chain,
+                                    const std::size_t& begin,
+                                    const std::size_t& end) {
+  const std::size_t num_spots = spot_shocks_.size();
+  const std::size_t num_vols = vol_shocks_.size();
+  constexpr double unit_spot_factor = 1.0;
+  constexpr double zero_log_spot_factor = 0.0;
+
+  for (std::size_t i = begin; i < end; ++i) {
+    const OptionRecord& record = chain[i];
+    const OptionIntermediates option = MakeOptionIntermediates(record);
+    double* option_prices = prices_.data() + i * num_vols * num_spots;
+
+    for (std::size_t k = 0; k < num_vols; ++k) {
+      const double sigma = record.sigma + vol_shocks_[k];
+      double* row = option_prices + k * num_spots;
+      if (sigma > 0.0 && record.T > 0.0) {
+        PriceRow(option, MakeVolIntermediates(option, sigma), record.type,
+                 spot_factors_.data(), log_spot_factors_.data(), num_spots,
+                 row);
+      } else {
+        PriceIntrinsicRow(option, record.type, spot_factors_.data(),
+                          num_spots, row);
+      }
+    }
+
+    // Unshocked price through the same kernel so PnL is exactly zero there
+    if (record.sigma > 0.0 && record.T > 0.0) {
+      PriceRow(option, MakeVolIntermediates(option, record.sigma), record.type,
+               &unit_spot_factor, &zero_log_spot_factor, 1, &base_prices_[i]);
+    } else {
+      PriceIntrinsicRow(option, record.type, &unit_spot_factor, 1,
+                        &base_prices_[i]);
+    }
+  }
+}
+
+std::size_t ScenarioRiskGrid::GetNumOptions() const { return num_options_; }
+
+std::size_t ScenarioRiskGrid::GetNumSpotShocks() const {
+  return spot_shocks_.size();
+}
+
+std::size_t ScenarioRiskGrid::GetNumVolShocks() const {
+  return vol_shocks_.size();
+}
+
+double ScenarioRiskGrid::GetBasePrice(const std::size_t& option) const {
+  return base_prices_[option];
+}
+
+double ScenarioRiskGrid::GetPrice(const std::size_t& option,
+                                  const std::size_t& vol_index,
+                                  const std::size_t& spot_index) const {
+  return GetPrices(option)[vol_index * spot_shocks_.size() + spot_index];
+}
+
+double ScenarioRiskGrid::GetPnL(const std::size_t& option,
+                                const std::size_t& vol_index,
+                                const std::size_t& spot_index) const {
+  return GetPrice(option, vol_index, spot_index) - base_prices_[option];
+}
+
+const double* ScenarioRiskGrid::GetPrices(const std::size_t& option) const {
+  return prices_.data() + option * vol_shocks_.size() * spot_shocks_.size();
+}
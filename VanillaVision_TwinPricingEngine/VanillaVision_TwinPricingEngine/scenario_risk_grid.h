@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "option_record.h"
+
+// Prices every option of a chain on a grid of spot and volatility shocks.
+// Spot shocks are relative (S * (1 + shock)) and volatility shocks are
+// absolute (sigma + shock). Results are stored option-major, then vol, then
+// spot, in a buffer that is reused across calls to Compute.
+class ScenarioRiskGrid {
+ private:
+  std::vector<double> spot_shocks_;
+  std::vector<double> vol_shocks_;
+  std::vector<double> spot_factors_;      // 1 + spot shock
+  std::vector<double> log_spot_factors_;  // log(1 + spot shock)
+  std::vector<double> prices_;
+  std::vector<double> base_prices_;
+  std::size_t num_options_ = 0;
+
+  void ComputeRange(const std::vector<OptionRecord>& chain,
+                    const std::size_t& begin, const std::size_t& end);
+
+ public:
+  ScenarioRiskGrid(const std::vector<double>& spot_shocks,
+                   const std::vector<double>& vol_shocks);
+
+  void Reserve(const std::size_t& num_options);
+  void Compute(const std::vector<OptionRecord>& chain);
+  void Compute(const std::vector<OptionRecord>& chain,
+               const int& num_threads);
+
+  std::size_t GetNumOptions() const;
+  std::size_t GetNumSpotShocks() const;
+  std::size_t GetNumVolShocks() const;
+
+  double GetBasePrice(const std::size_t& option) const;
+  double GetPrice(const std::size_t& option, const std::size_t& vol_index,
+                  const std::size_t& spot_index) const;
+  double GetPnL(const std::size_t& option, const std::size_t& vol_index,
+                const std::size_t& spot_index) const;
+  // Contiguous [vol][spot] prices of one option
+  const double* GetPrices(const std::size_t& option) const;
+};